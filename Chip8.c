@@ -1,6 +1,8 @@
 #include "Chip8.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 //---------------------defines-------------------
 
@@ -15,6 +17,10 @@
 
 extern struct Chip8 chip;
 
+//Machine state right after the ROM was loaded,
+//reset() restores from here instead of going back to disk
+static struct Chip8 pristine;
+
 
 
 /*
@@ -56,48 +62,26 @@ unsigned char chip8_fontset[80] =
 
 void init()
 {
+    //clear all registers, the stack, keys, display and memory
+    memset(&chip, 0, sizeof(chip));
+
     //0x200 (512) is where most Chip8 programs start
     chip.pc = 0x200;
 
-    //clear all other registers
-    chip.sp = 0;
-    chip.opcode = 0;
-    chip.I = 0;
-
-    //clear the display
-    for (int i = 0; i < 2048; i++) {
-        chip.graphics[i] = 0;
-    }
-
-    //clear stack keys and V
-    for (int i = 0; i < 16; i++) {
-        chip.stack[i] = 0;
-        chip.V[i] = 0;
-        chip.keys[i] = 0;
-    }
-
-    //clear the memory
-    for (int i = 0; i < 4096; i++) {
-        chip.memory[i] = 0;
-    }
-
     //load the fontset into memory
     //It should be stored in the interpreter area of Chip-8 memory (0x000 to 0x1FF)
     //(first 512 bytes)
-    for (int i = 0; i < 80; i++) {
-        chip.memory[i] = chip8_fontset[i];
-    }
+    memcpy(chip.memory, chip8_fontset, sizeof(chip8_fontset));
 
-    chip.soundTimer = 0;
-    chip.delayTimer = 0;
-
-    // Seed random number generator function
-    srand(time(NULL));
+    // Seed random number generator function (once is enough)
+    static int8_t seeded = 0;
+    if (!seeded) {
+        srand(time(NULL));
+        seeded = 1;
+    }
 }
 
 int8_t load(const char *file_path) {
-    init();
-
     FILE *rom = fopen(file_path, "rb");
     if (rom == NULL) {
         return 0;
@@ -108,34 +92,41 @@ int8_t load(const char *file_path) {
     long rom_size = ftell(rom);
     rewind(rom);
 
-    //allocate memory for the buffer
-    char *rom_buffer = (char *)malloc(sizeof(char) * rom_size);
-    if (rom_buffer == NULL) {
+    //0x000 to 0x1FF reserved for the interpreter hence - 512
+    //an empty file (e.g. truncated mid-save) is not a ROM either
+    if (rom_size <= 0 || rom_size > (4096 - 512)) {
+        fclose(rom);
         return 0;
     }
 
-    //copy ROM into buffer
-    size_t result = fread(rom_buffer, sizeof(char), (size_t)rom_size, rom);
+    //read into a buffer first so a failed (re)load leaves
+    //the running machine untouched
+    uint8_t rom_buffer[4096 - 512];
+    size_t result = fread(rom_buffer, sizeof(uint8_t), (size_t)rom_size, rom);
+    fclose(rom);
 
-    if (result != rom_size) {
+    if (result != (size_t)rom_size) {
         return 0;
     }
 
+    init();
+
     //Copy buffer into the memory
-    //0x000 to 0x1FF reserved for the interpreter hence - 512
-    if ((4096 - 512) > rom_size) {
-        for (int i = 0; i < rom_size; i++)
-            chip.memory[i + 512] = (uint8_t)rom_buffer[i];
-    } else {
-        return 0;
-    }
+    memcpy(chip.memory + 512, rom_buffer, (size_t)rom_size);
 
-    fclose(rom);
-    free(rom_buffer);
+    //force the first frame after a reset to repaint the screen
+    chip.drawFlag = 1;
+    pristine = chip;
 
     return 1;
 }
 
+void reset()
+{
+    //restore the freshly loaded machine, no disk access
+    chip = pristine;
+}
+
 void emulateCycle()
 {
     //Fetch instruction opcode
@@ -128,5 +128,6 @@ struct Chip8
 void init();
 void emulateCycle();
 int8_t load(const char *file_path);
+void reset();
 
 #endif // CHIP8_H
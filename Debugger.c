@@ -0,0 +1,273 @@
+#include "Debugger.h"
+#include "Chip8.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//---------------------defines-------------------
+
+#define BREAK_PC 0x1
+#define WATCH_READ 0x2
+#define WATCH_WRITE 0x4
+
+//-----------------------------------------------
+
+extern struct Chip8 chip;
+
+void (*cycle)() = emulateCycle;
+
+//BREAK_PC / WATCH_READ / WATCH_WRITE flags for every memory address
+static uint8_t points[4096];
+
+//WATCH_READ / WATCH_WRITE flags for the index register
+static uint8_t watchI;
+
+//number of armed flags, cycle goes back to emulateCycle when it drops to 0
+static int armed;
+
+//stop before every instruction
+static int8_t stepping;
+
+//pc of the last stop, so an instruction that doesn't advance pc
+//(FX0A waiting for a key, a jump to itself) is reported only once
+static int32_t stoppedAt = -1;
+
+static void rearm()
+{
+    cycle = (armed || stepping) ? debugCycle : emulateCycle;
+}
+
+static void arm(uint8_t *point, uint8_t flag)
+{
+    if (!(*point & flag)) {
+        *point |= flag;
+        armed++;
+    }
+}
+
+static void disarm(uint8_t *point)
+{
+    for (uint8_t flag = BREAK_PC; flag <= WATCH_WRITE; flag <<= 1) {
+        if (*point & flag)
+            armed--;
+    }
+    *point = 0;
+}
+
+//Decode the instruction at pc without running it and check it against
+//the armed points. Returns a description of the first hit or NULL,
+//the address (or value of I) that was hit is stored in addr
+static const char *hit(uint16_t *addr)
+{
+    uint16_t pc = chip.pc & 0xFFF;
+    uint16_t opcode = chip.memory[pc] << 8 | chip.memory[(pc + 1) & 0xFFF];
+    uint16_t x = (opcode & 0x0F00) >> 8;
+    uint8_t memAccess = 0;
+    uint8_t indexAccess = 0;
+    int count = 0;
+
+    if (points[pc] & BREAK_PC) {
+        *addr = pc;
+        return "breakpoint";
+    }
+
+    //only the instructions below touch I or memory (besides the fetch)
+    switch (opcode & 0xF000) {
+        case 0xA000:
+            //ANNN
+            indexAccess = WATCH_WRITE;
+            break;
+        case 0xD000:
+            //DXYN reads N sprite bytes from I
+            indexAccess = WATCH_READ;
+            memAccess = WATCH_READ;
+            count = opcode & 0x000F;
+            break;
+        case 0xF000:
+            switch (opcode & 0x00FF) {
+                case 0x001E:
+                    indexAccess = WATCH_READ | WATCH_WRITE;
+                    break;
+                case 0x0029:
+                    indexAccess = WATCH_WRITE;
+                    break;
+                case 0x0033:
+                    //BCD into I, I+1, I+2
+                    indexAccess = WATCH_READ;
+                    memAccess = WATCH_WRITE;
+                    count = 3;
+                    break;
+                case 0x0055:
+                    indexAccess = WATCH_READ;
+                    memAccess = WATCH_WRITE;
+                    count = x + 1;
+                    break;
+                case 0x0065:
+                    indexAccess = WATCH_READ;
+                    memAccess = WATCH_READ;
+                    count = x + 1;
+                    break;
+            }
+            break;
+    }
+
+    if (watchI & indexAccess) {
+        *addr = chip.I;
+        return (watchI & indexAccess & WATCH_WRITE) ? "I write" : "I read";
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint16_t a = (chip.I + i) & 0xFFF;
+        if (points[a] & memAccess) {
+            *addr = a;
+            return memAccess == WATCH_WRITE ? "write watchpoint" : "read watchpoint";
+        }
+    }
+
+    return NULL;
+}
+
+static void showState()
+{
+    uint16_t pc = chip.pc & 0xFFF;
+
+    printf("pc=%03X  opcode=%02X%02X  I=%03X  sp=%X  DT=%02X  ST=%02X\n",
+           chip.pc, chip.memory[pc], chip.memory[(pc + 1) & 0xFFF],
+           chip.I, chip.sp, chip.delayTimer, chip.soundTimer);
+
+    for (int i = 0; i < 16; i++)
+        printf("V%X=%02X%c", i, chip.V[i], i == 7 || i == 15 ? '\n' : ' ');
+}
+
+static void showPoints()
+{
+    if (watchI)
+        printf("I  %s%s\n", watchI & WATCH_READ ? " read" : "", watchI & WATCH_WRITE ? " write" : "");
+
+    for (int a = 0; a < 4096; a++) {
+        if (points[a])
+            printf("%03X%s%s%s\n", a,
+                   points[a] & BREAK_PC ? " break" : "",
+                   points[a] & WATCH_READ ? " read" : "",
+                   points[a] & WATCH_WRITE ? " write" : "");
+    }
+}
+
+static void showHelp()
+{
+    printf("b ADDR      break when pc reaches ADDR\n"
+           "r ADDR      break before memory[ADDR] is read\n"
+           "w ADDR      break before memory[ADDR] is written\n"
+           "d ADDR      delete all points at ADDR\n"
+           "ri / wi     break before I is read / written\n"
+           "di          delete the I watchpoints\n"
+           "l           list points\n"
+           "s           single step\n"
+           "c           continue\n"
+           "p           print registers\n"
+           "x ADDR [N]  dump N bytes of memory from ADDR\n"
+           "q           quit\n"
+           "Addresses are hexadecimal.\n");
+}
+
+//Read commands from the terminal until the user steps or continues.
+//The emulator window isn't updated while the monitor waits for input
+static void monitor()
+{
+    char line[64];
+    char cmd[8];
+    unsigned int addr;
+    unsigned int n;
+
+    showState();
+
+    while (1) {
+        printf("(chip8) ");
+        fflush(stdout);
+
+        //no terminal to talk to, let the ROM run on
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            stepping = 0;
+            return;
+        }
+
+        n = 16;
+        addr = 0;
+        int args = sscanf(line, "%7s %x %x", cmd, &addr, &n);
+        if (args < 1)
+            continue;
+
+        addr &= 0xFFF;
+
+        if (strcmp(cmd, "s") == 0) {
+            stepping = 1;
+            return;
+        } else if (strcmp(cmd, "c") == 0) {
+            stepping = 0;
+            return;
+        } else if (strcmp(cmd, "q") == 0) {
+            exit(0);
+        } else if (strcmp(cmd, "p") == 0) {
+            showState();
+        } else if (strcmp(cmd, "l") == 0) {
+            showPoints();
+        } else if (strcmp(cmd, "ri") == 0) {
+            arm(&watchI, WATCH_READ);
+        } else if (strcmp(cmd, "wi") == 0) {
+            arm(&watchI, WATCH_WRITE);
+        } else if (strcmp(cmd, "di") == 0) {
+            disarm(&watchI);
+        } else if (args < 2) {
+            showHelp();
+        } else if (strcmp(cmd, "b") == 0) {
+            arm(&points[addr], BREAK_PC);
+        } else if (strcmp(cmd, "r") == 0) {
+            arm(&points[addr], WATCH_READ);
+        } else if (strcmp(cmd, "w") == 0) {
+            arm(&points[addr], WATCH_WRITE);
+        } else if (strcmp(cmd, "d") == 0) {
+            disarm(&points[addr]);
+        } else if (strcmp(cmd, "x") == 0) {
+            //addresses wrap at 0xFFF, more than 4096 bytes only repeats itself
+            if (n > 4096)
+                n = 4096;
+
+            for (unsigned int i = 0; i < n; i++) {
+                if (i % 16 == 0)
+                    printf("%s%03X:", i ? "\n" : "", (addr + i) & 0xFFF);
+                printf(" %02X", chip.memory[(addr + i) & 0xFFF]);
+            }
+            printf("\n");
+        } else {
+            showHelp();
+        }
+    }
+}
+
+void debugBreak()
+{
+    stepping = 1;
+    rearm();
+}
+
+void debugCycle()
+{
+    const char *why = NULL;
+    uint16_t addr;
+
+    if (chip.pc != stoppedAt) {
+        stoppedAt = -1;
+        why = hit(&addr);
+    }
+
+    if (why != NULL)
+        printf("%s at %03X\n", why, addr);
+
+    if (why != NULL || stepping) {
+        stoppedAt = chip.pc;
+        monitor();
+        rearm();
+    }
+
+    emulateCycle();
+}
@@ -0,0 +1,31 @@
+/*
+    Debugger
+    ~~~~~~~~
+    A small console monitor for Chip8 ROMs: breakpoints on pc,
+    read/write watchpoints on memory and on I, and single stepping.
+
+    The main loop always runs the machine through the `cycle` pointer.
+    While nothing is armed it points straight at emulateCycle(), so the
+    emulator pays nothing for the debugger. Arming a breakpoint, a watchpoint
+    or stepping swaps in debugCycle(), which checks the next instruction
+    before handing it to emulateCycle().
+
+    Press F2 in the emulator window to break into the monitor,
+    commands are then read from the terminal (type h for help).
+*/
+
+#ifndef DEBUGGER_H
+#define DEBUGGER_H
+
+#include <stdint.h>
+
+//runs one instruction, either emulateCycle or debugCycle
+extern void (*cycle)();
+
+//stop before the next instruction and open the monitor
+void debugBreak();
+
+//instrumented cycle, only installed while something is armed
+void debugCycle();
+
+#endif // DEBUGGER_H
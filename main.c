@@ -1,4 +1,5 @@
 #include "Chip8.h"
+#include "Debugger.h"
 #include <stdio.h>
 #include "stdint.h"
 #include "SDL2/SDL.h"
@@ -13,8 +14,67 @@
 #include <unistd.h>
 #endif
 
+//for watching the ROM file
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <libgen.h>
+#include <string.h>
+#include <limits.h>
+#endif
+
 struct Chip8 chip;
 
+// Poll the ROM watch every 64 cycles (about 80ms) instead of making a syscall per instruction
+#define ROM_POLL_CYCLES 64
+
+#ifdef __linux__
+// Start watching the ROM's directory. Editors often save by writing a temp file
+// and renaming it over the original, so watching the file itself would lose track of it.
+// Returns a non-blocking inotify descriptor or -1 if the ROM can't be watched.
+static int watchRom(const char *file_path, char *rom_name, size_t len) {
+    char dir[PATH_MAX];
+    char base[PATH_MAX];
+
+    strncpy(dir, file_path, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    strncpy(base, file_path, sizeof(base) - 1);
+    base[sizeof(base) - 1] = '\0';
+
+    strncpy(rom_name, basename(base), len - 1);
+    rom_name[len - 1] = '\0';
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (inotify_add_watch(fd, dirname(dir), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Drain pending events, returns 1 if the ROM file was rewritten
+static int romChanged(int fd, const char *rom_name) {
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+    ssize_t len;
+
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + len; ) {
+            struct inotify_event *event = (struct inotify_event *)p;
+            if (event->len && strcmp(event->name, rom_name) == 0)
+                changed = 1;
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    return changed;
+}
+#endif
+
 // Keypad keymap for SDL
 uint8_t keymap[16] = {
     SDLK_x, SDLK_1, SDLK_2, SDLK_3,
@@ -71,16 +131,40 @@ int main(int argc, char **argv) {
     //Chip8 graphics -- 64 x 32 pixels
     uint32_t pixels[2048];
 
-reload:
-
     // Quit if  loading the ROM failed
     if (!load(argv[1])) {
         return 2;
 	}
 
+    //inotify descriptor for the ROM, -1 when edits aren't picked up automatically
+    int rom_watch = -1;
+
+#ifdef __linux__
+    //reload the ROM automatically whenever it is saved
+    char rom_name[NAME_MAX + 1];
+    rom_watch = watchRom(argv[1], rom_name, sizeof(rom_name));
+
+    //cycles left until the ROM watch is polled again
+    int rom_poll = ROM_POLL_CYCLES;
+#endif
+
+    if (rom_watch < 0) {
+        printf("Could not watch %s, press F1 to reload it\n", argv[1]);
+    }
+
     //Main loop
 	while (1) {
-        emulateCycle();
+        cycle();
+
+#ifdef __linux__
+        // On a failed reload (e.g. ROM grew too big) keep running the previous image
+        if (rom_watch >= 0 && --rom_poll == 0) {
+            rom_poll = ROM_POLL_CYCLES;
+            if (romChanged(rom_watch, rom_name) && !load(argv[1]))
+                printf("Reloading %s failed, keeping the previous ROM\n", argv[1]);
+        }
+#endif
+
         SDL_Event event;
 
         while (SDL_PollEvent(&event)) {
@@ -92,8 +176,14 @@ reload:
                 if (event.key.keysym.sym == SDLK_ESCAPE)
                     exit(0);
 
+                // Without a ROM watch F1 rereads the ROM so edits still get picked up,
+                // load() already resets the machine when it succeeds
                 if (event.key.keysym.sym == SDLK_F1)
-                    goto reload;
+                    if (rom_watch >= 0 || !load(argv[1]))
+                        reset();
+
+                if (event.key.keysym.sym == SDLK_F2)
+                    debugBreak();
 
                 for (int i = 0; i < 16; i++)
                     if (event.key.keysym.sym == keymap[i])